@@ -1,8 +1,56 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <strings.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
 
 #define TAM_HASH 10
+#define TAM_BLOCO_COMANDOS 4096
+
+// Índice de salas por nome e ancestrais para consultas de caminho.
+// O índice começa com TAM_INICIAL_INDICE_SALAS baldes e dobra quando há mais
+// salas que baldes.
+#define TAM_INICIAL_INDICE_SALAS 64
+
+// Filtro de Bloom das pistas associadas, dimensionado para uma taxa alvo de
+// falsos positivos p = 1/BLOOM_TAXA_FP_INVERSA com n = BLOOM_PISTAS_ESPERADAS.
+// No ótimo, k = log2(1/p) funções e m = n·k/ln 2 bits, o que dá p ≈ 2^-k.
+// k é arredondado para cima (p real ≤ alvo); 10000/6931 aproxima 1/ln 2.
+#define USAR_BLOOM 1
+#define BLOOM_PISTAS_ESPERADAS 100
+#define BLOOM_TAXA_FP_INVERSA 100
+#define BLOOM_FUNCOES ((BLOOM_TAXA_FP_INVERSA > 1) + (BLOOM_TAXA_FP_INVERSA > 2) + \
+                       (BLOOM_TAXA_FP_INVERSA > 4) + (BLOOM_TAXA_FP_INVERSA > 8) + \
+                       (BLOOM_TAXA_FP_INVERSA > 16) + (BLOOM_TAXA_FP_INVERSA > 32) + \
+                       (BLOOM_TAXA_FP_INVERSA > 64) + (BLOOM_TAXA_FP_INVERSA > 128) + \
+                       (BLOOM_TAXA_FP_INVERSA > 256) + (BLOOM_TAXA_FP_INVERSA > 512) + \
+                       (BLOOM_TAXA_FP_INVERSA > 1024) + (BLOOM_TAXA_FP_INVERSA > 2048) + \
+                       (BLOOM_TAXA_FP_INVERSA > 4096) + (BLOOM_TAXA_FP_INVERSA > 8192) + \
+                       (BLOOM_TAXA_FP_INVERSA > 16384) + (BLOOM_TAXA_FP_INVERSA > 32768))
+#define BLOOM_BITS (((long) BLOOM_PISTAS_ESPERADAS * BLOOM_FUNCOES * 10000 / 6931 + 8) / 8 * 8)
+
+// Diário de eventos: registros acumulados em memória e gravados em lote
+// (um fsync por lote), no máximo DIARIO_LOTE registros por vez. Cada sessão
+// grava em um diário próprio, que a análise agregada lê em paralelo.
+#define DIARIO_MAGICO "DQJ1"
+#define DIARIO_LOTE 64
+#define TAM_BUFFER_DIARIO 16384
+
+// Análise agregada de diários
+#define TAM_HASH_ANALISE 1024
+#define TOP_PISTAS 10
+#define MAX_THREADS_ANALISE 64
+
+// Catálogo de regras pista → suspeito carregado de arquivo
+#define TAM_INICIAL_CATALOGO 1024
+#define TAM_BLOCO_CATALOGO 4096
+#define MAX_THREADS_CATALOGO 64
+#define MIN_BYTES_POR_THREAD_CATALOGO (1 << 20)
+#define MAX_AVISOS_CATALOGO 5
 
 // Desafio Detective Quest
 // Tema 4 - Árvores e Tabela Hash
@@ -31,8 +79,17 @@ typedef struct Sala {
     char pista[100];
     struct Sala* esquerda;
     struct Sala* direita;
+    struct Sala** ancestral;              // ancestral[k] = sala 2^k níveis acima
+    int niveis;                           // posições em ancestral: ⌊log2 profundidade⌋ + 1
+    int profundidade;                     // distância até a raiz
+    unsigned int hash;                    // hash completo do nome
+    struct Sala* proxIndice;              // próxima sala no mesmo balde do índice
 } Sala;
 
+Sala** indiceSalas = NULL;
+int capacidadeIndiceSalas = 0;
+int totalSalas = 0;
+
 // ============================================================
 //  Struct da Árvore BST de Pistas
 // ============================================================
@@ -42,42 +99,207 @@ typedef struct PistaNode {
     struct PistaNode* direita;
 } PistaNode;
 
+struct Suspeito;
+
 // ============================================================
 //  Struct da Tabela Hash (Pista -> Suspeito)
 // ============================================================
 typedef struct HashNode {
     char pista[100];
     char suspeito[50];
-    int contador;
+    unsigned int hash;   // hash completo da pista (evita strcmp em colisões)
+    struct Suspeito* dono;
     struct HashNode* prox;
 } HashNode;
 
 HashNode* tabelaHash[TAM_HASH];
 
+// ============================================================
+//  Struct do Suspeito (índice reverso Suspeito -> Pistas)
+// ============================================================
+typedef struct Suspeito {
+    char nome[50];
+    unsigned int hash;   // hash completo do nome
+    HashNode** pistas;   // pistas associadas, em ordem de inserção
+    int contador;        // quantidade de pistas associadas
+    int capacidade;
+    struct Suspeito* prox;
+} Suspeito;
+
+Suspeito* tabelaSuspeitos[TAM_HASH];
+
+// ============================================================
+//  Filtro de Bloom (rejeita rapidamente pistas sem suspeito)
+// ============================================================
+unsigned char filtroBloom[BLOOM_BITS / 8];
+int bloomConsultas = 0;
+int bloomRejeicoes = 0;
+int bloomFalsosPositivos = 0;
+
+// ============================================================
+//  Diário de eventos (registro binário somente de acréscimo)
+// ============================================================
+//
+// Cada registro: [tipo:1][tam1:1][texto1][tam2:1][texto2]
+typedef enum {
+    REG_VISITA = 1,      // texto1 = nome da sala
+    REG_PISTA = 2,       // texto1 = pista coletada
+    REG_ASSOCIACAO = 3,  // texto1 = pista, texto2 = suspeito
+    REG_ACUSACAO = 4     // texto1 = acusado, texto2 = "1" se confirmado, "0" caso contrário
+} TipoRegistro;
+
+FILE* diario = NULL;
+unsigned char bufferDiario[TAM_BUFFER_DIARIO];
+size_t usadoDiario = 0;
+int registrosPendentes = 0;
+
+// ============================================================
+//  Catálogo de regras (Pista -> Suspeito) importado de arquivo
+// ============================================================
+// Os textos apontam para o conteúdo do arquivo importado, mantido em memória
+typedef struct RegraCatalogo {
+    const char* pista;
+    const char* suspeito;
+    unsigned int hash;
+    struct RegraCatalogo* prox;
+} RegraCatalogo;
+
+// As regras são alocadas em blocos para evitar um malloc por linha
+typedef struct BlocoCatalogo {
+    RegraCatalogo regras[TAM_BLOCO_CATALOGO];
+    int usadas;
+    struct BlocoCatalogo* prox;
+} BlocoCatalogo;
+
+// Conteúdo de um arquivo de catálogo importado
+typedef struct TextoCatalogo {
+    char* conteudo;
+    struct TextoCatalogo* prox;
+} TextoCatalogo;
+
+// Estado de uma thread da importação (trecho do arquivo na fase 1,
+// partição da tabela na fase 2)
+typedef struct ParteCatalogo {
+    char* inicio;
+    char* fim;
+    int primeiroTrecho;
+    int particoes;
+    RegraCatalogo* primeira[MAX_THREADS_CATALOGO];   // regras por partição, na ordem do arquivo
+    RegraCatalogo* ultima[MAX_THREADS_CATALOGO];
+    BlocoCatalogo* blocos;
+    long linhas;
+    long validas;
+    long invalidas;
+    long linhasInvalidas[MAX_AVISOS_CATALOGO];      // relativas ao início do trecho
+    int particao;
+    long importadas;
+    struct ParteCatalogo* partes;
+    int totalPartes;
+} ParteCatalogo;
+
+RegraCatalogo** catalogo = NULL;
+long capacidadeCatalogo = 0;
+long totalRegrasCatalogo = 0;
+BlocoCatalogo* blocosCatalogo = NULL;
+TextoCatalogo* textosCatalogo = NULL;
+
+// ============================================================
+//  Contadores da análise de diários (chave → total)
+// ============================================================
+typedef struct Contador {
+    char chave[100];
+    unsigned int hash;
+    long total;
+    struct Contador* prox;
+} Contador;
+
+// Estado de uma thread da análise: cada uma pega o próximo diário livre e
+// agrega em tabelas próprias, sem travas; as tabelas são somadas no final.
+typedef struct ParcialAnalise {
+    char** caminhos;
+    int quantidade;
+    atomic_int* proximoDiario;   // compartilhado entre as threads
+    Contador* citacoes[TAM_HASH_ANALISE];
+    Contador* pistas[TAM_HASH_ANALISE];
+    long acusacoes;
+    long confirmadas;
+    long registros;
+    int sucesso;
+} ParcialAnalise;
+
 // ============================================================
 //  Protótipos de funções
 // ============================================================
 Sala* criarSala(const char* nome, const char* pista);
 void conectarSalas(Sala* salaPai, Sala* salaEsquerda, Sala* salaDireita);
+void indexarSala(Sala* sala);
+void calcularAncestrais(Sala* sala, Sala* pai);
+void atualizarAncestrais(Sala* sala, Sala* pai);
+Sala* buscarSala(const char* nome);
+Sala* ancestralComum(Sala* a, Sala* b);
+void exibirCaminho(Sala* origem, Sala* destino);
+void exibirDescida(Sala* ancestral, Sala* sala);
 void explorarSalasComPistas(Sala* salaAtual, PistaNode** arvorePistas);
+void coletarPistaDaSala(Sala* sala, PistaNode** arvorePistas);
 
 PistaNode* inserirPista(PistaNode* raiz, const char* texto);
 void exibirPistas(PistaNode* raiz);
 
 void inicializarHash();
-int funcaoHash(const char* chave);
+unsigned int calcularHash(const char* chave);
 void inserirNaHash(const char* pista, const char* suspeito);
+void marcarNoBloom(unsigned int hash);
+int consultarBloom(unsigned int hash);
+void exibirEstatisticasBloom();
 void listarAssociacoes();
 char* encontrarSuspeito(const char* pista);
+Suspeito* buscarSuspeito(const char* nome);
+Suspeito* obterSuspeito(const char* nome);
+void listarPistasDoSuspeito(const Suspeito* suspeito);
+void listarSuspeitos();
+int distanciaEdicao(const unsigned long long* mascaras, int tamPadrao, const char* texto);
+Suspeito* buscarSuspeitoAproximado(const char* nome);
 void verificarSuspeitoFinal();
+int avaliarAcusacao(const char* acusado);
 void mostrarSuspeitoMaisCitado();
 
+int abrirDiario(const char* caminho);
+void registrarNoDiario(TipoRegistro tipo, const char* texto1, const char* texto2);
+void gravarLoteDiario();
+void desativarDiario(const char* motivo);
+void fecharDiario();
+FILE* abrirArquivoDiario(const char* caminho);
+int lerCampoDiario(FILE* arquivo, char* destino, size_t tamDestino);
+int lerRegistroDiario(FILE* arquivo, int* tipo, char* texto1, char* texto2);
+size_t limiteCampoDiario(int tipo, int campo);
+int reproduzirDiario(const char* caminho, PistaNode** arvorePistas);
+
+void contar(Contador** tabela, const char* chave, long quantidade);
+void juntarContadores(Contador** destino, Contador** origem);
+void* analisarParte(void* argumento);
+int compararContadores(const void* a, const void* b);
+void exibirContadores(Contador** tabela, int limite);
+void freeContadores(Contador** tabela);
+int analisarDiarios(int quantidade, char* caminhos[]);
+
+long importarCatalogo(const char* caminho);
+void* analisarTrechoCatalogo(void* argumento);
+void* ligarParticaoCatalogo(void* argumento);
+int ligarNoCatalogo(RegraCatalogo* regra);
+void redimensionarCatalogo(long novaCapacidade);
+const char* consultarCatalogo(const char* pista);
+void freeCatalogo();
+
+void executarModoComandos(Sala* salaInicial, PistaNode** arvorePistas);
+int executarComando(char* linha, Sala** salaAtual, PistaNode** arvorePistas);
+
 void limparBuffer();
 void freePistaTree(PistaNode* raiz);
+void freeTabelaHash();
 // ============================================================
 //  FUNÇÃO PRINCIPAL
 // ============================================================
-int main() {
+int main(int argc, char* argv[]) {
     PistaNode* arvorePistas = NULL;
     inicializarHash();
 
@@ -94,6 +316,62 @@ int main() {
     conectarSalas(biblioteca, estudio, jardim);
     conectarSalas(cozinha, deposito, jantar);
 
+    int modoComandos = 0;
+    const char* arquivoDiario = NULL;
+    const char* arquivoReplay = NULL;
+    const char* arquivoCatalogo = NULL;
+
+    // Análise agregada: todos os argumentos seguintes são diários
+    if (argc > 2 && strcmp(argv[1], "--analisar") == 0)
+        return analisarDiarios(argc - 2, argv + 2) ? 0 : 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--comandos") == 0)
+            modoComandos = 1;
+        else if (strcmp(argv[i], "--diario") == 0 && i + 1 < argc)
+            arquivoDiario = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            arquivoReplay = argv[++i];
+        else if (strcmp(argv[i], "--catalogo") == 0 && i + 1 < argc)
+            arquivoCatalogo = argv[++i];
+        else {
+            printf("Opção inválida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // Reconstrói o estado do jogo a partir de um diário gravado
+    if (arquivoReplay != NULL) {
+        if (!reproduzirDiario(arquivoReplay, &arvorePistas))
+            return 1;
+
+        printf("\n📜 PISTAS COLETADAS:\n");
+        exibirPistas(arvorePistas);
+        printf("\nASSOCIAÇÕES PISTA → SUSPEITO:\n");
+        listarAssociacoes();
+        mostrarSuspeitoMaisCitado();
+
+        freePistaTree(arvorePistas);
+        freeTabelaHash();
+        return 0;
+    }
+
+    if (arquivoCatalogo != NULL && importarCatalogo(arquivoCatalogo) < 0)
+        return 1;
+
+    if (arquivoDiario != NULL && !abrirDiario(arquivoDiario))
+        return 1;
+
+    // Modo de comandos: o jogo é conduzido por linhas lidas da entrada padrão
+    if (modoComandos) {
+        executarModoComandos(hallEntrada, &arvorePistas);
+        fecharDiario();
+        freePistaTree(arvorePistas);
+        freeTabelaHash();
+        freeCatalogo();
+        return 0;
+    }
+
     printf("Bem-vindo(a) à mansão Detective Quest!\n");
     printf("Começando a exploração...\n");
     explorarSalasComPistas(hallEntrada, &arvorePistas);
@@ -108,11 +386,16 @@ int main() {
     printf("\nASSOCIAÇÕES PISTA → SUSPEITO:\n");
     listarAssociacoes();
 
+    printf("\nPISTAS POR SUSPEITO:\n");
+    listarSuspeitos();
+
     mostrarSuspeitoMaisCitado();
     verificarSuspeitoFinal();
 
+    fecharDiario();
     freePistaTree(arvorePistas);
     freeTabelaHash();
+    freeCatalogo();
     return 0;
 }
 
@@ -121,7 +404,7 @@ int main() {
 // ============================================================
 
 /**
- * @brief Cria uma nova sala com o nome e pista fornecidos.
+ * @brief Cria uma nova sala com o nome e pista fornecidos e a registra no índice por nome.
  * @param nome Nome da sala.
  * @param pista Pista presente na sala.
  * @return Ponteiro para a nova sala criada.
@@ -137,10 +420,52 @@ Sala* criarSala(const char* nome, const char* pista) {
     strcpy(nova->pista, pista);
     nova->esquerda = NULL;
     nova->direita = NULL;
+    nova->ancestral = NULL;
+    nova->niveis = 0;
+    calcularAncestrais(nova, NULL);
+    indexarSala(nova);
     return nova;
 }
 
 
+/**
+ * @brief Insere uma sala no índice por nome, dobrando o índice quando fica cheio.
+ * @param sala Sala a indexar.
+ */
+void indexarSala(Sala* sala) {
+    if (totalSalas >= capacidadeIndiceSalas) {
+        int novaCapacidade = capacidadeIndiceSalas ? capacidadeIndiceSalas * 2 : TAM_INICIAL_INDICE_SALAS;
+        Sala** novoIndice = (Sala**) calloc(novaCapacidade, sizeof(Sala*));
+        if (!novoIndice) {
+            printf("Erro ao alocar memória!\n");
+            exit(1);
+        }
+
+        // Redistribui as salas já indexadas
+        for (int i = 0; i < capacidadeIndiceSalas; i++) {
+            Sala* atual = indiceSalas[i];
+            while (atual) {
+                Sala* prox = atual->proxIndice;
+                int indice = atual->hash % novaCapacidade;
+                atual->proxIndice = novoIndice[indice];
+                novoIndice[indice] = atual;
+                atual = prox;
+            }
+        }
+
+        free(indiceSalas);
+        indiceSalas = novoIndice;
+        capacidadeIndiceSalas = novaCapacidade;
+    }
+
+    sala->hash = calcularHash(sala->nome);
+    int indice = sala->hash % capacidadeIndiceSalas;
+    sala->proxIndice = indiceSalas[indice];
+    indiceSalas[indice] = sala;
+    totalSalas++;
+}
+
+
 /**
  * @brief Conecta duas salas à esquerda e direita de uma sala pai.
  * @param salaPai Ponteiro para a sala pai.
@@ -150,6 +475,193 @@ Sala* criarSala(const char* nome, const char* pista) {
 void conectarSalas(Sala* salaPai, Sala* salaEsquerda, Sala* salaDireita) {
     salaPai->esquerda = salaEsquerda;
     salaPai->direita = salaDireita;
+
+    if (salaEsquerda != NULL)
+        atualizarAncestrais(salaEsquerda, salaPai);
+    if (salaDireita != NULL)
+        atualizarAncestrais(salaDireita, salaPai);
+}
+
+
+/**
+ * @brief Calcula profundidade e tabela de ancestrais de uma sala a partir do pai.
+ *
+ * A tabela tem uma posição para cada salto 2^k que cabe na profundidade,
+ * então não há limite fixo de andares. Como ancestral[k] =
+ * ancestral[k-1]->ancestral[k-1] e a sala do meio está a pelo menos
+ * 2^(k-1) níveis da raiz, cada tabela depende apenas das tabelas acima.
+ * @param sala Sala a atualizar.
+ * @param pai Sala pai (NULL para a raiz).
+ */
+void calcularAncestrais(Sala* sala, Sala* pai) {
+    sala->profundidade = (pai != NULL) ? pai->profundidade + 1 : 0;
+
+    int niveis = 0;
+    while (niveis < 31 && (1 << niveis) <= sala->profundidade)
+        niveis++;
+
+    if (niveis != sala->niveis) {
+        free(sala->ancestral);
+        sala->ancestral = NULL;
+        if (niveis > 0) {
+            sala->ancestral = (Sala**) malloc(niveis * sizeof(Sala*));
+            if (!sala->ancestral) {
+                printf("Erro ao alocar memória!\n");
+                exit(1);
+            }
+        }
+        sala->niveis = niveis;
+    }
+
+    for (int k = 0; k < niveis; k++)
+        sala->ancestral[k] = (k == 0) ? pai : sala->ancestral[k - 1]->ancestral[k - 1];
+}
+
+
+/**
+ * @brief Recalcula os ancestrais de uma sala e de todas as suas descendentes.
+ *
+ * Percorre a subárvore com uma pilha explícita (pais antes dos filhos), o que
+ * permite conectar salas em qualquer ordem sem recursão por nível.
+ * @param sala Sala a atualizar.
+ * @param pai Nova sala pai (NULL para a raiz).
+ */
+void atualizarAncestrais(Sala* sala, Sala* pai) {
+    calcularAncestrais(sala, pai);
+    if (sala->esquerda == NULL && sala->direita == NULL)
+        return;
+
+    int capacidade = 64;
+    int topo = 0;
+    Sala** pilha = (Sala**) malloc(capacidade * sizeof(Sala*));
+    if (!pilha) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+    pilha[topo++] = sala;
+
+    while (topo > 0) {
+        Sala* atual = pilha[--topo];
+        Sala* filhos[2] = { atual->esquerda, atual->direita };
+
+        for (int i = 0; i < 2; i++) {
+            if (filhos[i] == NULL)
+                continue;
+            calcularAncestrais(filhos[i], atual);
+            if (topo == capacidade) {
+                capacidade *= 2;
+                pilha = (Sala**) realloc(pilha, capacidade * sizeof(Sala*));
+                if (!pilha) {
+                    printf("Erro ao alocar memória!\n");
+                    exit(1);
+                }
+            }
+            pilha[topo++] = filhos[i];
+        }
+    }
+
+    free(pilha);
+}
+
+
+/**
+ * @brief Procura uma sala pelo nome no índice de salas.
+ * @param nome Nome da sala procurada.
+ * @return Ponteiro para a sala ou NULL se não encontrada.
+ */
+Sala* buscarSala(const char* nome) {
+    if (indiceSalas == NULL)
+        return NULL;
+
+    unsigned int hash = calcularHash(nome);
+    for (Sala* atual = indiceSalas[hash % capacidadeIndiceSalas]; atual; atual = atual->proxIndice) {
+        if (atual->hash == hash && strcmp(atual->nome, nome) == 0)
+            return atual;
+    }
+    return NULL;
+}
+
+
+/**
+ * @brief Encontra o ancestral comum mais próximo de duas salas (binary lifting).
+ * @param a Primeira sala.
+ * @param b Segunda sala.
+ * @return Ancestral comum mais próximo ou NULL se estiverem em árvores diferentes.
+ */
+Sala* ancestralComum(Sala* a, Sala* b) {
+    if (a->profundidade < b->profundidade) {
+        Sala* temp = a;
+        a = b;
+        b = temp;
+    }
+
+    // Sobe a sala mais funda até a profundidade da outra, do maior salto ao menor
+    int diferenca = a->profundidade - b->profundidade;
+    for (int k = a->niveis - 1; k >= 0; k--) {
+        if (k < a->niveis && (diferenca & (1 << k)))
+            a = a->ancestral[k];
+    }
+
+    if (a == b)
+        return a;
+
+    // Sobe as duas juntas (mesma profundidade, mesmas tabelas), sempre pelo
+    // maior salto que ainda não as encontra
+    for (int k = a->niveis - 1; k >= 0; k--) {
+        if (k < a->niveis && a->ancestral[k] != b->ancestral[k]) {
+            a = a->ancestral[k];
+            b = b->ancestral[k];
+        }
+    }
+
+    // Chegou às raízes sem encontro: as salas estão em árvores diferentes
+    return (a->niveis > 0) ? a->ancestral[0] : NULL;
+}
+
+
+/**
+ * @brief Exibe as salas do caminho entre duas salas, passando pelo ancestral comum.
+ * @param origem Sala de partida.
+ * @param destino Sala de chegada.
+ */
+void exibirCaminho(Sala* origem, Sala* destino) {
+    Sala* comum = ancestralComum(origem, destino);
+    if (comum == NULL) {
+        printf("ERRO salas sem ligação\n");
+        return;
+    }
+
+    for (Sala* atual = origem; atual != comum; atual = atual->ancestral[0])
+        printf("%s\n", atual->nome);
+    printf("%s\n", comum->nome);
+    exibirDescida(comum, destino);
+}
+
+
+/**
+ * @brief Exibe as salas do caminho que desce de um ancestral até uma sala (sem o ancestral).
+ * @param ancestral Sala de onde a descida parte.
+ * @param sala Sala de chegada.
+ */
+void exibirDescida(Sala* ancestral, Sala* sala) {
+    int passos = sala->profundidade - ancestral->profundidade;
+    if (passos <= 0)
+        return;
+
+    // Sobe guardando as salas e imprime na ordem inversa (de cima para baixo)
+    Sala** descida = (Sala**) malloc(passos * sizeof(Sala*));
+    if (!descida) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+    for (int i = passos - 1; i >= 0; i--) {
+        descida[i] = sala;
+        sala = sala->ancestral[0];
+    }
+    for (int i = 0; i < passos; i++)
+        printf("%s\n", descida[i]->nome);
+
+    free(descida);
 }
 
 // ============================================================
@@ -167,23 +679,7 @@ void explorarSalasComPistas(Sala* salaAtual, PistaNode** arvorePistas) {
     while (salaAtual != NULL) {
         printf("\nVocê está em: %s\n", salaAtual->nome);
 
-        if (strlen(salaAtual->pista) > 0) {
-            printf("🕵️ PISTA ENCONTRADA: %s\n", salaAtual->pista);
-
-            *arvorePistas = inserirPista(*arvorePistas, salaAtual->pista);
-
-            // ASSOCIAÇÃO AUTOMÁTICA COM SUSPEITOS
-            if (strstr(salaAtual->pista, "Livro"))
-                inserirNaHash(salaAtual->pista, "Mordomo");
-            else if (strstr(salaAtual->pista, "Faca"))
-                inserirNaHash(salaAtual->pista, "Cozinheiro");
-            else if (strstr(salaAtual->pista, "Carta"))
-                inserirNaHash(salaAtual->pista, "Herdeira");
-            else if (strstr(salaAtual->pista, "Pegadas"))
-                inserirNaHash(salaAtual->pista, "Jardineiro");
-
-            strcpy(salaAtual->pista, "");
-        }
+        coletarPistaDaSala(salaAtual, arvorePistas);
 
         // Se for folha → fim do caminho
         if (salaAtual->esquerda == NULL && salaAtual->direita == NULL) {
@@ -198,6 +694,9 @@ void explorarSalasComPistas(Sala* salaAtual, PistaNode** arvorePistas) {
             printf("  (d) Ir para a direita  → %s\n", salaAtual->direita->nome);
         printf("  (s) Sair da exploração\n");
 
+        // O jogador vai esperar pela digitação: bom momento para gravar o lote
+        gravarLoteDiario();
+
         printf("Opção: ");
         scanf(" %c", &opcao);
         limparBuffer();
@@ -218,6 +717,38 @@ void explorarSalasComPistas(Sala* salaAtual, PistaNode** arvorePistas) {
     }
 }
 
+/**
+ * @brief Registra a visita à sala e coleta a pista (se houver), associando-a ao suspeito.
+ * @param sala Sala visitada.
+ * @param arvorePistas Ponteiro para a árvore de pistas coletadas.
+ */
+void coletarPistaDaSala(Sala* sala, PistaNode** arvorePistas) {
+    registrarNoDiario(REG_VISITA, sala->nome, "");
+
+    if (strlen(sala->pista) == 0)
+        return;
+
+    printf("🕵️ PISTA ENCONTRADA: %s\n", sala->pista);
+
+    *arvorePistas = inserirPista(*arvorePistas, sala->pista);
+    registrarNoDiario(REG_PISTA, sala->pista, "");
+
+    // ASSOCIAÇÃO AUTOMÁTICA COM SUSPEITOS (catálogo primeiro, depois regras fixas)
+    const char* suspeitoCatalogo = consultarCatalogo(sala->pista);
+    if (suspeitoCatalogo != NULL)
+        inserirNaHash(sala->pista, suspeitoCatalogo);
+    else if (strstr(sala->pista, "Livro"))
+        inserirNaHash(sala->pista, "Mordomo");
+    else if (strstr(sala->pista, "Faca"))
+        inserirNaHash(sala->pista, "Cozinheiro");
+    else if (strstr(sala->pista, "Carta"))
+        inserirNaHash(sala->pista, "Herdeira");
+    else if (strstr(sala->pista, "Pegadas"))
+        inserirNaHash(sala->pista, "Jardineiro");
+
+    strcpy(sala->pista, "");
+}
+
 // ============================================================
 //  BST DE PISTAS
 // ============================================================
@@ -237,9 +768,10 @@ PistaNode* inserirPista(PistaNode* raiz, const char* texto) {
         return nova;
     }
 
-    if (strcmp(texto, raiz->texto) < 0) {
+    int comparacao = strcmp(texto, raiz->texto);
+    if (comparacao < 0) {
         raiz->esquerda = inserirPista(raiz->esquerda, texto);
-    } else if (strcmp(texto, raiz->texto) > 0) {
+    } else if (comparacao > 0) {
         raiz->direita = inserirPista(raiz->direita, texto);
     }
 
@@ -268,52 +800,218 @@ void exibirPistas(PistaNode* raiz) {
  * @brief Inicializa a tabela hash.
  */
 void inicializarHash() {
-    for (int i = 0; i < TAM_HASH; i++)
+    for (int i = 0; i < TAM_HASH; i++) {
         tabelaHash[i] = NULL;
+        tabelaSuspeitos[i] = NULL;
+    }
+
+    memset(filtroBloom, 0, sizeof(filtroBloom));
+    bloomConsultas = 0;
+    bloomRejeicoes = 0;
+    bloomFalsosPositivos = 0;
 }
 
 
 /**
- * @brief Função de hash simples baseada na soma dos valores ASCII.
- * @param chave Chave para calcular o índice.
- * @return Índice na tabela hash.
+ * @brief Calcula o hash completo (FNV-1a) de uma chave.
+ *
+ * Diferente da soma ASCII, distingue anagramas e pistas com prefixo comum.
+ * @param chave Chave a ser espalhada.
+ * @return Valor de hash de 32 bits.
  */
-int funcaoHash(const char* chave) {
-    int soma = 0;
-    for (int i = 0; chave[i]; i++)
-        soma += chave[i];
-    return soma % TAM_HASH;
+unsigned int calcularHash(const char* chave) {
+    unsigned int hash = 2166136261u;
+    for (int i = 0; chave[i]; i++) {
+        hash ^= (unsigned char) chave[i];
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
+
 /**
- * @brief Insere uma associação pista → suspeito na tabela hash.
+ * @brief Insere uma associação pista → suspeito na tabela hash e no índice de suspeitos.
  * @param pista Texto da pista.
  * @param suspeito Nome do suspeito.
  */
 void inserirNaHash(const char* pista, const char* suspeito) {
-    int indice = funcaoHash(pista);
+    registrarNoDiario(REG_ASSOCIACAO, pista, suspeito);
+
+    unsigned int hash = calcularHash(pista);
+    int indice = hash % TAM_HASH;
 
     HashNode* atual = tabelaHash[indice];
     while (atual) {
         // Evita duplicar a MESMA pista
-        if (strcmp(atual->pista, pista) == 0) {
+        if (atual->hash == hash && strcmp(atual->pista, pista) == 0) {
             return; // Pista já cadastrada
         }
-
-        // Se o suspeito já existe, incrementa o contador
-        if (strcmp(atual->suspeito, suspeito) == 0) {
-            atual->contador++;
-            return;
-        }
         atual = atual->prox;
     }
 
+    Suspeito* dono = obterSuspeito(suspeito);
+
     HashNode* novo = (HashNode*) malloc(sizeof(HashNode));
     strcpy(novo->pista, pista);
     strcpy(novo->suspeito, suspeito);
-    novo->contador = 1;
+    novo->hash = hash;
+    novo->dono = dono;
     novo->prox = tabelaHash[indice];
     tabelaHash[indice] = novo;
+
+    // Índice reverso: acrescenta a pista à lista do suspeito
+    if (dono->contador == dono->capacidade) {
+        dono->capacidade = dono->capacidade ? dono->capacidade * 2 : 4;
+        dono->pistas = (HashNode**) realloc(dono->pistas, dono->capacidade * sizeof(HashNode*));
+        if (!dono->pistas) {
+            printf("Erro ao alocar memória!\n");
+            exit(1);
+        }
+    }
+    dono->pistas[dono->contador++] = novo;
+
+    if (USAR_BLOOM)
+        marcarNoBloom(hash);
+}
+
+
+/**
+ * @brief Busca um suspeito pelo nome no índice de suspeitos.
+ * @param nome Nome do suspeito.
+ * @return Ponteiro para o suspeito ou NULL se não houver pistas contra ele.
+ */
+Suspeito* buscarSuspeito(const char* nome) {
+    unsigned int hash = calcularHash(nome);
+
+    for (Suspeito* atual = tabelaSuspeitos[hash % TAM_HASH]; atual; atual = atual->prox) {
+        if (atual->hash == hash && strcmp(atual->nome, nome) == 0)
+            return atual;
+    }
+    return NULL;
+}
+
+
+/**
+ * @brief Busca um suspeito pelo nome, criando-o se ainda não existir.
+ * @param nome Nome do suspeito.
+ * @return Ponteiro para o suspeito.
+ */
+Suspeito* obterSuspeito(const char* nome) {
+    Suspeito* existente = buscarSuspeito(nome);
+    if (existente != NULL)
+        return existente;
+
+    Suspeito* novo = (Suspeito*) malloc(sizeof(Suspeito));
+    if (!novo) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+
+    unsigned int hash = calcularHash(nome);
+    strcpy(novo->nome, nome);
+    novo->hash = hash;
+    novo->pistas = NULL;
+    novo->contador = 0;
+    novo->capacidade = 0;
+    novo->prox = tabelaSuspeitos[hash % TAM_HASH];
+    tabelaSuspeitos[hash % TAM_HASH] = novo;
+    return novo;
+}
+
+
+/**
+ * @brief Lista todas as pistas associadas a um suspeito.
+ * @param suspeito Suspeito consultado.
+ */
+void listarPistasDoSuspeito(const Suspeito* suspeito) {
+    for (int i = 0; i < suspeito->contador; i++)
+        printf("  🔎 %s\n", suspeito->pistas[i]->pista);
+}
+
+
+/**
+ * @brief Calcula a distância de edição entre um padrão e um texto (Myers, bit-paralelo).
+ *
+ * Cada bit das máscaras representa uma posição do padrão, então uma coluna
+ * inteira da matriz de distâncias é atualizada com poucas operações por caractere
+ * do texto. Maiúsculas e minúsculas são consideradas iguais.
+ * @param mascaras Máscara de ocorrência de cada byte no padrão (256 posições).
+ * @param tamPadrao Tamanho do padrão (1 a 64).
+ * @param texto Texto comparado.
+ * @return Distância de edição (inserções, remoções e substituições).
+ */
+int distanciaEdicao(const unsigned long long* mascaras, int tamPadrao, const char* texto) {
+    unsigned long long ultimo = 1ULL << (tamPadrao - 1);
+    unsigned long long pv = ~0ULL;
+    unsigned long long mv = 0;
+    int distancia = tamPadrao;
+
+    for (int j = 0; texto[j]; j++) {
+        unsigned long long eq = mascaras[(unsigned char) tolower((unsigned char) texto[j])];
+        unsigned long long xv = eq | mv;
+        unsigned long long xh = (((eq & pv) + pv) ^ pv) | eq;
+        unsigned long long ph = mv | ~(xh | pv);
+        unsigned long long mh = pv & xh;
+
+        if (ph & ultimo)
+            distancia++;
+        else if (mh & ultimo)
+            distancia--;
+
+        // A primeira linha da matriz cresce de 1 em 1 (distância global)
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+
+    return distancia;
+}
+
+
+/**
+ * @brief Procura o suspeito com nome mais próximo do digitado.
+ *
+ * Aceita até 1 + tamanho/5 edições (ex.: "jardinero" → "Jardineiro").
+ * @param nome Nome digitado.
+ * @return Suspeito mais próximo ou NULL se nenhum estiver perto o bastante.
+ */
+Suspeito* buscarSuspeitoAproximado(const char* nome) {
+    int tamPadrao = strlen(nome);
+    if (tamPadrao == 0 || tamPadrao > 64)
+        return NULL;
+
+    unsigned long long mascaras[256] = { 0 };
+    for (int i = 0; i < tamPadrao; i++)
+        mascaras[(unsigned char) tolower((unsigned char) nome[i])] |= 1ULL << i;
+
+    Suspeito* melhor = NULL;
+    int menorDistancia = 1 + tamPadrao / 5;
+
+    for (int i = 0; i < TAM_HASH; i++) {
+        for (Suspeito* atual = tabelaSuspeitos[i]; atual; atual = atual->prox) {
+            int distancia = distanciaEdicao(mascaras, tamPadrao, atual->nome);
+            if (distancia < menorDistancia || (distancia == menorDistancia && melhor == NULL)) {
+                menorDistancia = distancia;
+                melhor = atual;
+            }
+        }
+    }
+
+    return melhor;
+}
+
+
+/**
+ * @brief Lista todos os suspeitos com suas respectivas pistas.
+ */
+void listarSuspeitos() {
+    for (int i = 0; i < TAM_HASH; i++) {
+        for (Suspeito* atual = tabelaSuspeitos[i]; atual; atual = atual->prox) {
+            printf("%s (%d pistas):\n", atual->nome, atual->contador);
+            listarPistasDoSuspeito(atual);
+        }
+    }
 }
 
 
@@ -323,19 +1021,78 @@ void inserirNaHash(const char* pista, const char* suspeito) {
  * @return Nome do suspeito ou NULL se não encontrado.
  */
 char* encontrarSuspeito(const char* pista) {
-    int indice = funcaoHash(pista);
-    HashNode* atual = tabelaHash[indice];
+    unsigned int hash = calcularHash(pista);
+
+    if (USAR_BLOOM) {
+        bloomConsultas++;
+        if (!consultarBloom(hash)) {
+            bloomRejeicoes++;
+            return NULL;
+        }
+    }
+
+    HashNode* atual = tabelaHash[hash % TAM_HASH];
 
     while (atual) {
-        if (strcmp(atual->pista, pista) == 0)
+        if (atual->hash == hash && strcmp(atual->pista, pista) == 0)
             return atual->suspeito;
         atual = atual->prox;
     }
 
+    if (USAR_BLOOM)
+        bloomFalsosPositivos++;
     return NULL;
 }
 
 
+/**
+ * @brief Marca no filtro de Bloom os bits correspondentes a um hash.
+ *
+ * Usa hashing duplo: o i-ésimo bit é (h1 + i·h2) mod BLOOM_BITS.
+ * @param hash Hash completo da pista.
+ */
+void marcarNoBloom(unsigned int hash) {
+    unsigned int h2 = ((hash >> 16) | (hash << 16)) | 1u;
+    for (int i = 0; i < BLOOM_FUNCOES; i++) {
+        unsigned int bit = (hash + i * h2) % BLOOM_BITS;
+        filtroBloom[bit / 8] |= (unsigned char) (1u << (bit % 8));
+    }
+}
+
+
+/**
+ * @brief Consulta o filtro de Bloom.
+ * @param hash Hash completo da pista.
+ * @return 0 se a pista certamente não está na tabela, 1 se talvez esteja.
+ */
+int consultarBloom(unsigned int hash) {
+    unsigned int h2 = ((hash >> 16) | (hash << 16)) | 1u;
+    for (int i = 0; i < BLOOM_FUNCOES; i++) {
+        unsigned int bit = (hash + i * h2) % BLOOM_BITS;
+        if (!(filtroBloom[bit / 8] & (1u << (bit % 8))))
+            return 0;
+    }
+    return 1;
+}
+
+
+/**
+ * @brief Exibe as estatísticas do filtro de Bloom nas buscas por suspeito.
+ */
+void exibirEstatisticasBloom() {
+    int negativas = bloomRejeicoes + bloomFalsosPositivos;
+
+    printf("Filtro: %ld bits, %d funções, taxa alvo %.2f%%\n",
+           (long) BLOOM_BITS, BLOOM_FUNCOES, 100.0 / BLOOM_TAXA_FP_INVERSA);
+    printf("Consultas: %d\n", bloomConsultas);
+    printf("Rejeitadas pelo filtro: %d\n", bloomRejeicoes);
+    printf("Falsos positivos: %d\n", bloomFalsosPositivos);
+    if (negativas > 0)
+        printf("Taxa de falsos positivos: %.2f%%\n",
+               100.0 * bloomFalsosPositivos / negativas);
+}
+
+
 /**
  * @brief Lista todas as associações pista → suspeito na tabela hash.
  */
@@ -344,7 +1101,7 @@ void listarAssociacoes() {
         HashNode* atual = tabelaHash[i];
         while (atual) {
             printf("%s → %s (%d pistas)\n",
-                   atual->pista, atual->suspeito, atual->contador);
+                   atual->pista, atual->suspeito, atual->dono->contador);
             atual = atual->prox;
         }
     }
@@ -359,13 +1116,11 @@ void mostrarSuspeitoMaisCitado() {
     char nome[50] = "";
 
     for (int i = 0; i < TAM_HASH; i++) {
-        HashNode* atual = tabelaHash[i];
-        while (atual) {
+        for (Suspeito* atual = tabelaSuspeitos[i]; atual; atual = atual->prox) {
             if (atual->contador > maior) {
                 maior = atual->contador;
-                strcpy(nome, atual->suspeito);
+                strcpy(nome, atual->nome);
             }
-            atual = atual->prox;
         }
     }
 
@@ -379,25 +1134,1080 @@ void mostrarSuspeitoMaisCitado() {
  */
 void verificarSuspeitoFinal() {
     char acusado[50];
+    // Grava o lote antes de esperar pela resposta do jogador
+    gravarLoteDiario();
+
     printf("\n⚖️ Quem você acusa? ");
     fgets(acusado, 50, stdin);
     acusado[strcspn(acusado, "\n")] = '\0';
 
-    for (int i = 0; i < TAM_HASH; i++) {
-        HashNode* atual = tabelaHash[i];
+    avaliarAcusacao(acusado);
+}
+
+
+/**
+ * @brief Avalia a acusação contra um suspeito, exibe o veredito e o registra no diário.
+ * @param acusado Nome do suspeito acusado.
+ * @return 1 se o culpado foi confirmado, 0 caso contrário.
+ */
+int avaliarAcusacao(const char* acusado) {
+    Suspeito* suspeito = buscarSuspeito(acusado);
+
+    // Nome não encontrado exatamente: tenta corrigir erros de digitação
+    if (suspeito == NULL) {
+        suspeito = buscarSuspeitoAproximado(acusado);
+        if (suspeito != NULL) {
+            printf("Considerando \"%s\".\n", suspeito->nome);
+            acusado = suspeito->nome;
+        }
+    }
+
+    if (suspeito == NULL) {
+        printf("Nenhuma pista contra esse suspeito.\n");
+        registrarNoDiario(REG_ACUSACAO, acusado, "0");
+        return 0;
+    }
+
+    int confirmado = suspeito->contador >= 2;
+    if (confirmado)
+        printf("CULPADO CONFIRMADO!\n");
+    else
+        printf("Provas insuficientes.\n");
+    registrarNoDiario(REG_ACUSACAO, acusado, confirmado ? "1" : "0");
+    return confirmado;
+}
+
+// ============================================================
+//  DIÁRIO DE EVENTOS
+// ============================================================
+
+/**
+ * @brief Cria o arquivo de diário da sessão.
+ *
+ * O arquivo não pode existir: acrescentar sessões a um diário antigo juntaria
+ * várias sessões num único arquivo, que a análise só consegue ler em sequência.
+ * @param caminho Caminho do arquivo.
+ * @return 1 em caso de sucesso, 0 em caso de erro.
+ */
+int abrirDiario(const char* caminho) {
+    diario = fopen(caminho, "wbx");
+    if (diario == NULL) {
+        if (errno == EEXIST)
+            printf("Diário %s já existe; use um arquivo novo para cada sessão.\n", caminho);
+        else
+            printf("Erro ao abrir o diário %s!\n", caminho);
+        return 0;
+    }
+
+    usadoDiario = 0;
+    registrosPendentes = 0;
+
+    if (fwrite(DIARIO_MAGICO, 1, strlen(DIARIO_MAGICO), diario) != strlen(DIARIO_MAGICO) ||
+        fflush(diario) != 0) {
+        desativarDiario("falha ao gravar o cabeçalho");
+        return 0;
+    }
+    return 1;
+}
+
+
+/**
+ * @brief Acrescenta um registro ao lote do diário (não faz nada se o diário estiver fechado).
+ * @param tipo Tipo do evento.
+ * @param texto1 Primeiro campo do registro.
+ * @param texto2 Segundo campo do registro (pode ser vazio).
+ */
+void registrarNoDiario(TipoRegistro tipo, const char* texto1, const char* texto2) {
+    if (diario == NULL)
+        return;
+
+    // Limita cada campo ao tamanho da struct que o recebe na reprodução
+    size_t tam1 = strlen(texto1);
+    size_t tam2 = strlen(texto2);
+    if (tam1 > limiteCampoDiario(tipo, 1)) tam1 = limiteCampoDiario(tipo, 1);
+    if (tam2 > limiteCampoDiario(tipo, 2)) tam2 = limiteCampoDiario(tipo, 2);
+
+    if (usadoDiario + 3 + tam1 + tam2 > TAM_BUFFER_DIARIO)
+        gravarLoteDiario();
+
+    bufferDiario[usadoDiario++] = (unsigned char) tipo;
+    bufferDiario[usadoDiario++] = (unsigned char) tam1;
+    memcpy(bufferDiario + usadoDiario, texto1, tam1);
+    usadoDiario += tam1;
+    bufferDiario[usadoDiario++] = (unsigned char) tam2;
+    memcpy(bufferDiario + usadoDiario, texto2, tam2);
+    usadoDiario += tam2;
+
+    if (++registrosPendentes >= DIARIO_LOTE)
+        gravarLoteDiario();
+}
+
+
+/**
+ * @brief Informa o maior tamanho aceito para um campo de registro do diário.
+ *
+ * Pistas vão para campos de 100 bytes (PistaNode, HashNode) e nomes de salas
+ * e suspeitos para campos de 50 bytes (Sala, HashNode, Suspeito).
+ * @param tipo Tipo do registro.
+ * @param campo 1 para o primeiro campo, 2 para o segundo.
+ * @return Tamanho máximo do texto, sem o '\0'.
+ */
+size_t limiteCampoDiario(int tipo, int campo) {
+    switch (tipo) {
+        case REG_VISITA:
+            return (campo == 1) ? 49 : 0;
+        case REG_PISTA:
+            return (campo == 1) ? 99 : 0;
+        case REG_ASSOCIACAO:
+            return (campo == 1) ? 99 : 49;
+        case REG_ACUSACAO:
+            return (campo == 1) ? 49 : 1;
+        default:
+            return 255;
+    }
+}
+
+
+/**
+ * @brief Grava o lote pendente do diário em disco com um único fsync.
+ */
+void gravarLoteDiario() {
+    if (diario == NULL || usadoDiario == 0)
+        return;
+
+    if (fwrite(bufferDiario, 1, usadoDiario, diario) != usadoDiario) {
+        desativarDiario("falha ao gravar o lote");
+        return;
+    }
+    if (fflush(diario) != 0) {
+        desativarDiario("falha ao descarregar o lote");
+        return;
+    }
+    if (fsync(fileno(diario)) != 0) {
+        desativarDiario("falha no fsync");
+        return;
+    }
+
+    usadoDiario = 0;
+    registrosPendentes = 0;
+}
+
+
+/**
+ * @brief Avisa sobre um erro de gravação e desliga o diário pelo resto da sessão.
+ * @param motivo Descrição da operação que falhou.
+ */
+void desativarDiario(const char* motivo) {
+    fprintf(stderr, "⚠️ DIÁRIO DESATIVADO: %s (%s). Os eventos seguintes não serão registrados.\n",
+            motivo, strerror(errno));
+    fclose(diario);
+    diario = NULL;
+    usadoDiario = 0;
+    registrosPendentes = 0;
+}
+
+
+/**
+ * @brief Grava o lote pendente e fecha o diário.
+ */
+void fecharDiario() {
+    if (diario == NULL)
+        return;
+
+    gravarLoteDiario();
+    if (diario != NULL && fclose(diario) != 0)
+        fprintf(stderr, "⚠️ Erro ao fechar o diário: %s\n", strerror(errno));
+    diario = NULL;
+}
+
+
+/**
+ * @brief Abre um diário para leitura e valida o cabeçalho.
+ * @param caminho Caminho do arquivo de diário.
+ * @return Arquivo posicionado no primeiro registro, ou NULL em caso de erro.
+ */
+FILE* abrirArquivoDiario(const char* caminho) {
+    FILE* arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o diário %s!\n", caminho);
+        return NULL;
+    }
+    setvbuf(arquivo, NULL, _IOFBF, 1 << 20);
+
+    char magico[4];
+    if (fread(magico, 1, 4, arquivo) != 4 || memcmp(magico, DIARIO_MAGICO, 4) != 0) {
+        printf("Arquivo %s não é um diário válido!\n", caminho);
+        fclose(arquivo);
+        return NULL;
+    }
+    return arquivo;
+}
+
+
+/**
+ * @brief Lê um campo de texto (tamanho + bytes) de um registro do diário.
+ * @param arquivo Arquivo do diário.
+ * @param destino Buffer de destino (recebe o texto terminado em '\0').
+ * @param tamDestino Tamanho do buffer de destino.
+ * @return 1 em caso de sucesso, 0 se o registro estiver truncado.
+ */
+int lerCampoDiario(FILE* arquivo, char* destino, size_t tamDestino) {
+    int tam = fgetc(arquivo);
+    if (tam == EOF || (size_t) tam >= tamDestino)
+        return 0;
+    if (fread(destino, 1, tam, arquivo) != (size_t) tam)
+        return 0;
+    destino[tam] = '\0';
+    return 1;
+}
+
+
+/**
+ * @brief Lê o próximo registro do diário.
+ * @param arquivo Arquivo do diário.
+ * @param tipo Recebe o tipo do registro.
+ * @param texto1 Buffer de 256 bytes para o primeiro campo.
+ * @param texto2 Buffer de 256 bytes para o segundo campo.
+ * @return 1 se um registro foi lido, 0 no fim do arquivo, -1 se truncado.
+ */
+int lerRegistroDiario(FILE* arquivo, int* tipo, char* texto1, char* texto2) {
+    *tipo = fgetc(arquivo);
+    if (*tipo == EOF)
+        return 0;
+    if (!lerCampoDiario(arquivo, texto1, 256) || !lerCampoDiario(arquivo, texto2, 256))
+        return -1;
+    return 1;
+}
+
+
+/**
+ * @brief Reconstrói pistas, associações e salas visitadas a partir de um diário.
+ * @param caminho Caminho do arquivo de diário.
+ * @param arvorePistas Ponteiro para a árvore de pistas a ser reconstruída.
+ * @return 1 em caso de sucesso, 0 em caso de erro.
+ */
+int reproduzirDiario(const char* caminho, PistaNode** arvorePistas) {
+    FILE* arquivo = abrirArquivoDiario(caminho);
+    if (arquivo == NULL)
+        return 0;
+
+    Sala* salaAtual = NULL;
+    char texto1[256];
+    char texto2[256];
+    int registros = 0;
+    int rejeitados = 0;
+    int tipo;
+    int lido;
+
+    while ((lido = lerRegistroDiario(arquivo, &tipo, texto1, texto2)) != 0) {
+        if (lido < 0) {
+            printf("Registro truncado após %d registros; restante ignorado.\n", registros);
+            break;
+        }
+
+        // Campos maiores que as structs de destino (diário corrompido ou forjado)
+        if (strlen(texto1) > limiteCampoDiario(tipo, 1) || strlen(texto2) > limiteCampoDiario(tipo, 2)) {
+            rejeitados++;
+            continue;
+        }
+
+        switch (tipo) {
+            case REG_VISITA:
+                salaAtual = buscarSala(texto1);
+                break;
+            case REG_PISTA:
+                *arvorePistas = inserirPista(*arvorePistas, texto1);
+                if (salaAtual != NULL && strcmp(salaAtual->pista, texto1) == 0)
+                    strcpy(salaAtual->pista, "");
+                break;
+            case REG_ASSOCIACAO:
+                inserirNaHash(texto1, texto2);
+                break;
+            case REG_ACUSACAO:
+                printf("Acusação registrada: %s (%s)\n", texto1,
+                       strcmp(texto2, "1") == 0 ? "confirmada" : "não confirmada");
+                break;
+            default:
+                printf("Registro desconhecido (%d) ignorado.\n", tipo);
+                break;
+        }
+        registros++;
+    }
+
+    fclose(arquivo);
+
+    printf("%d registros reproduzidos.\n", registros);
+    if (rejeitados > 0)
+        printf("%d registro(s) com campos longos demais ignorado(s).\n", rejeitados);
+    if (salaAtual != NULL)
+        printf("Última sala visitada: %s\n", salaAtual->nome);
+    return 1;
+}
+
+// ============================================================
+//  ANÁLISE DE DIÁRIOS
+// ============================================================
+
+/**
+ * @brief Soma uma quantidade ao contador de uma chave, criando-o se necessário.
+ * @param tabela Tabela hash de contadores (TAM_HASH_ANALISE posições).
+ * @param chave Chave a ser contada.
+ * @param quantidade Valor a somar.
+ */
+void contar(Contador** tabela, const char* chave, long quantidade) {
+    unsigned int hash = calcularHash(chave);
+    int indice = hash % TAM_HASH_ANALISE;
+
+    for (Contador* atual = tabela[indice]; atual; atual = atual->prox) {
+        if (atual->hash == hash && strcmp(atual->chave, chave) == 0) {
+            atual->total += quantidade;
+            return;
+        }
+    }
+
+    Contador* novo = (Contador*) malloc(sizeof(Contador));
+    if (!novo) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+    strncpy(novo->chave, chave, sizeof(novo->chave) - 1);
+    novo->chave[sizeof(novo->chave) - 1] = '\0';
+    novo->hash = hash;
+    novo->total = quantidade;
+    novo->prox = tabela[indice];
+    tabela[indice] = novo;
+}
+
+
+/**
+ * @brief Ordena contadores por total decrescente (empate: ordem alfabética).
+ */
+int compararContadores(const void* a, const void* b) {
+    const Contador* ca = *(const Contador* const*) a;
+    const Contador* cb = *(const Contador* const*) b;
+
+    if (ca->total != cb->total)
+        return (ca->total < cb->total) ? 1 : -1;
+    return strcmp(ca->chave, cb->chave);
+}
+
+
+/**
+ * @brief Exibe os contadores em ordem decrescente de total.
+ * @param tabela Tabela hash de contadores.
+ * @param limite Quantidade máxima de linhas (0 = todas).
+ */
+void exibirContadores(Contador** tabela, int limite) {
+    int quantidade = 0;
+    for (int i = 0; i < TAM_HASH_ANALISE; i++)
+        for (Contador* atual = tabela[i]; atual; atual = atual->prox)
+            quantidade++;
+
+    if (quantidade == 0) {
+        printf("  (nenhum registro)\n");
+        return;
+    }
+
+    Contador** ordenados = (Contador**) malloc(quantidade * sizeof(Contador*));
+    if (!ordenados) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+
+    int n = 0;
+    for (int i = 0; i < TAM_HASH_ANALISE; i++)
+        for (Contador* atual = tabela[i]; atual; atual = atual->prox)
+            ordenados[n++] = atual;
+
+    qsort(ordenados, quantidade, sizeof(Contador*), compararContadores);
+
+    if (limite == 0 || limite > quantidade)
+        limite = quantidade;
+    for (int i = 0; i < limite; i++)
+        printf("  %-40s %ld\n", ordenados[i]->chave, ordenados[i]->total);
+
+    free(ordenados);
+}
+
+
+/**
+ * @brief Libera os contadores de uma tabela de análise.
+ * @param tabela Tabela hash de contadores.
+ */
+void freeContadores(Contador** tabela) {
+    for (int i = 0; i < TAM_HASH_ANALISE; i++) {
+        Contador* atual = tabela[i];
         while (atual) {
-            if (strcmp(atual->suspeito, acusado) == 0) {
-                if (atual->contador >= 2)
-                    printf("CULPADO CONFIRMADO!\n");
-                else
-                    printf("Provas insuficientes.\n");
+            Contador* temp = atual;
+            atual = atual->prox;
+            free(temp);
+        }
+        tabela[i] = NULL;
+    }
+}
+
+
+/**
+ * @brief Soma todos os contadores de uma tabela em outra e libera a origem.
+ * @param destino Tabela que recebe as somas.
+ * @param origem Tabela somada (fica vazia).
+ */
+void juntarContadores(Contador** destino, Contador** origem) {
+    for (int i = 0; i < TAM_HASH_ANALISE; i++)
+        for (Contador* atual = origem[i]; atual; atual = atual->prox)
+            contar(destino, atual->chave, atual->total);
+    freeContadores(origem);
+}
+
+
+/**
+ * @brief Corpo de uma thread da análise: agrega diários até acabarem.
+ * @param argumento Ponteiro para o ParcialAnalise da thread.
+ * @return NULL.
+ */
+void* analisarParte(void* argumento) {
+    ParcialAnalise* parte = (ParcialAnalise*) argumento;
+    char texto1[256];
+    char texto2[256];
+    int tipo;
+    int lido;
+    int i;
+
+    while ((i = atomic_fetch_add(parte->proximoDiario, 1)) < parte->quantidade) {
+        FILE* arquivo = abrirArquivoDiario(parte->caminhos[i]);
+        if (arquivo == NULL) {
+            parte->sucesso = 0;
+            continue;
+        }
+
+        while ((lido = lerRegistroDiario(arquivo, &tipo, texto1, texto2)) > 0) {
+            parte->registros++;
+            if (tipo == REG_PISTA) {
+                contar(parte->pistas, texto1, 1);
+            } else if (tipo == REG_ASSOCIACAO) {
+                contar(parte->citacoes, texto2, 1);
+            } else if (tipo == REG_ACUSACAO) {
+                parte->acusacoes++;
+                if (strcmp(texto2, "1") == 0)
+                    parte->confirmadas++;
+            }
+        }
+        if (lido < 0)
+            printf("Diário %s truncado; restante ignorado.\n", parte->caminhos[i]);
+
+        fclose(arquivo);
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Percorre vários diários em paralelo e exibe estatísticas agregadas das sessões.
+ *
+ * Como cada sessão grava seu próprio diário, as sessões são distribuídas entre
+ * até uma thread por núcleo; cada diário é lido em fluxo, registro a registro,
+ * sem reconstruir o jogo.
+ * @param quantidade Quantidade de diários.
+ * @param caminhos Caminhos dos diários.
+ * @return 1 se todos os diários foram lidos, 0 se algum falhou.
+ */
+int analisarDiarios(int quantidade, char* caminhos[]) {
+    Contador* citacoes[TAM_HASH_ANALISE] = { NULL };
+    Contador* pistas[TAM_HASH_ANALISE] = { NULL };
+    long acusacoes = 0;
+    long confirmadas = 0;
+    long registros = 0;
+    int sucesso = 1;
+    atomic_int proximoDiario = 0;
+
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int numThreads = (nucleos > 0) ? (int) nucleos : 1;
+    if (numThreads > quantidade)
+        numThreads = quantidade;
+    if (numThreads > MAX_THREADS_ANALISE)
+        numThreads = MAX_THREADS_ANALISE;
+
+    ParcialAnalise* partes = (ParcialAnalise*) calloc(numThreads, sizeof(ParcialAnalise));
+    pthread_t threads[MAX_THREADS_ANALISE];
+    if (!partes) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+
+    for (int t = 0; t < numThreads; t++) {
+        partes[t].caminhos = caminhos;
+        partes[t].quantidade = quantidade;
+        partes[t].proximoDiario = &proximoDiario;
+        partes[t].sucesso = 1;
+    }
+
+    // A thread principal processa a parte 0; as demais ganham threads próprias
+    int criadas = 1;
+    while (criadas < numThreads &&
+           pthread_create(&threads[criadas], NULL, analisarParte, &partes[criadas]) == 0)
+        criadas++;
+    analisarParte(&partes[0]);
+    for (int t = 1; t < criadas; t++)
+        pthread_join(threads[t], NULL);
+
+    // Redução: soma as tabelas locais
+    for (int t = 0; t < criadas; t++) {
+        juntarContadores(citacoes, partes[t].citacoes);
+        juntarContadores(pistas, partes[t].pistas);
+        acusacoes += partes[t].acusacoes;
+        confirmadas += partes[t].confirmadas;
+        registros += partes[t].registros;
+        if (!partes[t].sucesso)
+            sucesso = 0;
+    }
+    free(partes);
+
+    printf("📊 ANÁLISE DE %d DIÁRIO(S), %ld REGISTROS\n", quantidade, registros);
+
+    printf("\nCitações por suspeito:\n");
+    exibirContadores(citacoes, 0);
+
+    printf("\nPistas mais coletadas:\n");
+    exibirContadores(pistas, TOP_PISTAS);
+
+    printf("\nAcusações: %ld (%ld confirmadas", acusacoes, confirmadas);
+    if (acusacoes > 0)
+        printf(", %.1f%%", 100.0 * confirmadas / acusacoes);
+    printf(")\n");
+
+    freeContadores(citacoes);
+    freeContadores(pistas);
+    return sucesso;
+}
+
+// ============================================================
+//  CATÁLOGO DE PISTAS
+// ============================================================
+
+/**
+ * @brief Importa regras pista → suspeito de um arquivo, uma por linha.
+ *
+ * Cada linha tem a pista e o suspeito separados por tabulação (TSV) ou,
+ * na falta dela, pelo último ';' ou ',' (CSV). Linhas vazias, começando
+ * com '#' ou um cabeçalho "pista<sep>suspeito" na primeira linha são
+ * ignorados; se a mesma pista aparecer mais de uma vez, vale a primeira.
+ *
+ * O arquivo é lido inteiro e dividido em trechos de linhas completas. Na
+ * primeira fase cada thread analisa um trecho e separa as regras por
+ * partição (balde da tabela mod número de partições); na segunda, cada
+ * thread liga na tabela apenas as regras da sua partição. Como partições
+ * diferentes nunca compartilham baldes, nenhuma trava é necessária, e as
+ * listas são percorridas na ordem do arquivo, preservando "vale a primeira".
+ * @param caminho Caminho do arquivo de catálogo.
+ * @return Quantidade de regras importadas, ou -1 em caso de erro.
+ */
+long importarCatalogo(const char* caminho) {
+    FILE* arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o catálogo %s!\n", caminho);
+        return -1;
+    }
+
+    fseek(arquivo, 0, SEEK_END);
+    long tamanho = ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+
+    // O conteúdo fica vivo enquanto o catálogo existir: as regras apontam para ele
+    TextoCatalogo* texto = (TextoCatalogo*) malloc(sizeof(TextoCatalogo));
+    char* conteudo = (char*) malloc(tamanho + 1);
+    if (!texto || !conteudo) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+    if (tamanho < 0 || fread(conteudo, 1, tamanho, arquivo) != (size_t) tamanho) {
+        printf("Erro ao ler o catálogo %s!\n", caminho);
+        fclose(arquivo);
+        free(conteudo);
+        free(texto);
+        return -1;
+    }
+    fclose(arquivo);
+    conteudo[tamanho] = '\0';
+    texto->conteudo = conteudo;
+    texto->prox = textosCatalogo;
+    textosCatalogo = texto;
+
+    // Uma thread por núcleo (arquivos pequenos não compensam); o número de
+    // partições é potência de 2 para dividir igualmente os baldes da tabela
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int numThreads = (nucleos > 0) ? (int) nucleos : 1;
+    if (numThreads > MAX_THREADS_CATALOGO)
+        numThreads = MAX_THREADS_CATALOGO;
+    if (numThreads > tamanho / MIN_BYTES_POR_THREAD_CATALOGO + 1)
+        numThreads = tamanho / MIN_BYTES_POR_THREAD_CATALOGO + 1;
+    int particoes = 1;
+    while (particoes * 2 <= numThreads)
+        particoes *= 2;
+
+    ParteCatalogo* partes = (ParteCatalogo*) calloc(numThreads, sizeof(ParteCatalogo));
+    pthread_t threads[MAX_THREADS_CATALOGO];
+    if (!partes) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+
+    // Divide o conteúdo em trechos que terminam em fim de linha
+    char* inicio = conteudo;
+    for (int t = 0; t < numThreads; t++) {
+        char* fim = (t == numThreads - 1) ? conteudo + tamanho : conteudo + tamanho * (t + 1) / numThreads;
+        if (fim < inicio)
+            fim = inicio;
+        while (fim < conteudo + tamanho && fim > inicio && fim[-1] != '\n')
+            fim++;
+
+        partes[t].inicio = inicio;
+        partes[t].fim = fim;
+        partes[t].particoes = particoes;
+        partes[t].primeiroTrecho = (t == 0);
+        partes[t].partes = partes;
+        partes[t].totalPartes = numThreads;
+        inicio = fim;
+    }
+
+    // Fase 1: análise das linhas em paralelo
+    int criadas = 1;
+    while (criadas < numThreads &&
+           pthread_create(&threads[criadas], NULL, analisarTrechoCatalogo, &partes[criadas]) == 0)
+        criadas++;
+    analisarTrechoCatalogo(&partes[0]);
+    for (int t = 1; t < criadas; t++)
+        pthread_join(threads[t], NULL);
+
+    // Trechos sem thread (falha em pthread_create) são analisados aqui
+    for (int t = criadas; t < numThreads; t++)
+        analisarTrechoCatalogo(&partes[t]);
+
+    long validas = 0;
+    for (int t = 0; t < numThreads; t++)
+        validas += partes[t].validas;
+
+    // Dimensiona a tabela para ~1 regra por balde antes de ligar as novas
+    long necessario = totalRegrasCatalogo + validas;
+    long capacidade = capacidadeCatalogo ? capacidadeCatalogo : TAM_INICIAL_CATALOGO;
+    while (capacidade < necessario)
+        capacidade *= 2;
+    if (capacidade != capacidadeCatalogo)
+        redimensionarCatalogo(capacidade);
+
+    // Fase 2: cada thread liga as regras de uma partição
+    for (int p = 0; p < particoes; p++)
+        partes[p].particao = p;
+    criadas = 1;
+    while (criadas < particoes &&
+           pthread_create(&threads[criadas], NULL, ligarParticaoCatalogo, &partes[criadas]) == 0)
+        criadas++;
+    ligarParticaoCatalogo(&partes[0]);
+    for (int p = 1; p < criadas; p++)
+        pthread_join(threads[p], NULL);
+    for (int p = criadas; p < particoes; p++)
+        ligarParticaoCatalogo(&partes[p]);
+
+    // Junta os blocos de regras e os diagnósticos de todas as partes
+    long importadas = 0;
+    long invalidas = 0;
+    long linhasAntes = 0;
+    int exibidas = 0;
+
+    for (int t = 0; t < numThreads; t++) {
+        importadas += partes[t].importadas;
+        invalidas += partes[t].invalidas;
+
+        for (int i = 0; i < partes[t].invalidas && i < MAX_AVISOS_CATALOGO && exibidas < MAX_AVISOS_CATALOGO; i++, exibidas++)
+            printf("Catálogo %s, linha %ld: entrada inválida ignorada.\n",
+                   caminho, linhasAntes + partes[t].linhasInvalidas[i]);
+        linhasAntes += partes[t].linhas;
+
+        while (partes[t].blocos) {
+            BlocoCatalogo* bloco = partes[t].blocos;
+            partes[t].blocos = bloco->prox;
+            bloco->prox = blocosCatalogo;
+            blocosCatalogo = bloco;
+        }
+    }
+    free(partes);
+
+    totalRegrasCatalogo += importadas;
+    if (invalidas > 0)
+        printf("Catálogo %s: %ld linha(s) inválida(s).\n", caminho, invalidas);
+    return importadas;
+}
+
+
+/**
+ * @brief Fase 1 da importação: analisa as linhas de um trecho do catálogo.
+ *
+ * As regras válidas são criadas nos blocos da própria parte e encadeadas,
+ * na ordem do arquivo, na lista da partição do seu balde.
+ * @param argumento Ponteiro para o ParteCatalogo do trecho.
+ * @return NULL.
+ */
+void* analisarTrechoCatalogo(void* argumento) {
+    ParteCatalogo* parte = (ParteCatalogo*) argumento;
+    char* linha = parte->inicio;
+    int procurarCabecalho = parte->primeiroTrecho;
+
+    while (linha < parte->fim) {
+        char* quebra = memchr(linha, '\n', parte->fim - linha);
+        char* fimLinha = quebra ? quebra : parte->fim;
+        char* proxima = quebra ? quebra + 1 : parte->fim;
+
+        parte->linhas++;
+        if (fimLinha > linha && fimLinha[-1] == '\r')
+            fimLinha--;
+        *fimLinha = '\0';
+
+        if (linha[0] == '\0' || linha[0] == '#') {
+            linha = proxima;
+            continue;
+        }
+
+        char* separador = strchr(linha, '\t');
+        if (separador == NULL)
+            separador = strrchr(linha, ';');
+        if (separador == NULL)
+            separador = strrchr(linha, ',');
+
+        const char* pista = linha;
+        const char* suspeito = NULL;
+        if (separador != NULL) {
+            *separador = '\0';
+            suspeito = separador + 1;
+        }
+
+        // Cabeçalho opcional na primeira linha com conteúdo
+        if (procurarCabecalho) {
+            procurarCabecalho = 0;
+            if (suspeito != NULL && strcasecmp(pista, "pista") == 0 && strcasecmp(suspeito, "suspeito") == 0) {
+                linha = proxima;
+                continue;
+            }
+        }
+
+        // Os limites vêm dos campos de HashNode, para onde a regra é copiada
+        if (suspeito == NULL || pista[0] == '\0' || suspeito[0] == '\0' ||
+            strlen(pista) >= 100 || strlen(suspeito) >= 50) {
+            if (parte->invalidas < MAX_AVISOS_CATALOGO)
+                parte->linhasInvalidas[parte->invalidas] = parte->linhas;
+            parte->invalidas++;
+            linha = proxima;
+            continue;
+        }
+
+        if (parte->blocos == NULL || parte->blocos->usadas == TAM_BLOCO_CATALOGO) {
+            BlocoCatalogo* bloco = (BlocoCatalogo*) malloc(sizeof(BlocoCatalogo));
+            if (!bloco) {
+                printf("Erro ao alocar memória!\n");
+                exit(1);
+            }
+            bloco->usadas = 0;
+            bloco->prox = parte->blocos;
+            parte->blocos = bloco;
+        }
+
+        RegraCatalogo* nova = &parte->blocos->regras[parte->blocos->usadas++];
+        nova->pista = pista;
+        nova->suspeito = suspeito;
+        nova->hash = calcularHash(pista);
+        nova->prox = NULL;
+
+        int p = nova->hash & (parte->particoes - 1);
+        if (parte->ultima[p] != NULL)
+            parte->ultima[p]->prox = nova;
+        else
+            parte->primeira[p] = nova;
+        parte->ultima[p] = nova;
+        parte->validas++;
+
+        linha = proxima;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Fase 2 da importação: liga na tabela as regras de uma partição.
+ *
+ * Só toca baldes cujo índice mod número de partições é a partição da
+ * thread, por isso roda sem travas em paralelo com as demais partições.
+ * @param argumento Ponteiro para o ParteCatalogo que identifica a partição.
+ * @return NULL.
+ */
+void* ligarParticaoCatalogo(void* argumento) {
+    ParteCatalogo* parte = (ParteCatalogo*) argumento;
+    int p = parte->particao;
+
+    for (int t = 0; t < parte->totalPartes; t++) {
+        RegraCatalogo* atual = parte->partes[t].primeira[p];
+        while (atual) {
+            RegraCatalogo* prox = atual->prox;
+            parte->importadas += ligarNoCatalogo(atual);
+            atual = prox;
+        }
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief Liga uma regra ao seu balde, se a pista ainda não tiver uma.
+ * @param regra Regra já preenchida (pista, suspeito e hash).
+ * @return 1 se a regra foi ligada, 0 se a pista já existia.
+ */
+int ligarNoCatalogo(RegraCatalogo* regra) {
+    long indice = regra->hash & (capacidadeCatalogo - 1);
+
+    for (RegraCatalogo* atual = catalogo[indice]; atual; atual = atual->prox) {
+        if (atual->hash == regra->hash && strcmp(atual->pista, regra->pista) == 0)
+            return 0;
+    }
+
+    regra->prox = catalogo[indice];
+    catalogo[indice] = regra;
+    return 1;
+}
+
+
+/**
+ * @brief Redistribui as regras do catálogo em uma tabela com nova capacidade.
+ * @param novaCapacidade Quantidade de baldes (potência de 2).
+ */
+void redimensionarCatalogo(long novaCapacidade) {
+    RegraCatalogo** novaTabela = (RegraCatalogo**) calloc(novaCapacidade, sizeof(RegraCatalogo*));
+    if (!novaTabela) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+
+    for (long i = 0; i < capacidadeCatalogo; i++) {
+        RegraCatalogo* atual = catalogo[i];
+        while (atual) {
+            RegraCatalogo* prox = atual->prox;
+            long indice = atual->hash & (novaCapacidade - 1);
+            atual->prox = novaTabela[indice];
+            novaTabela[indice] = atual;
+            atual = prox;
+        }
+    }
+
+    free(catalogo);
+    catalogo = novaTabela;
+    capacidadeCatalogo = novaCapacidade;
+}
+
+
+/**
+ * @brief Consulta o suspeito que o catálogo associa a uma pista.
+ * @param pista Texto da pista.
+ * @return Nome do suspeito ou NULL se o catálogo não tiver regra para a pista.
+ */
+const char* consultarCatalogo(const char* pista) {
+    if (catalogo == NULL)
+        return NULL;
+
+    unsigned int hash = calcularHash(pista);
+    for (RegraCatalogo* atual = catalogo[hash & (capacidadeCatalogo - 1)]; atual; atual = atual->prox) {
+        if (atual->hash == hash && strcmp(atual->pista, pista) == 0)
+            return atual->suspeito;
+    }
+    return NULL;
+}
+
+
+/**
+ * @brief Libera a memória do catálogo importado.
+ */
+void freeCatalogo() {
+    while (blocosCatalogo) {
+        BlocoCatalogo* temp = blocosCatalogo;
+        blocosCatalogo = blocosCatalogo->prox;
+        free(temp);
+    }
+    while (textosCatalogo) {
+        TextoCatalogo* temp = textosCatalogo;
+        textosCatalogo = textosCatalogo->prox;
+        free(temp->conteudo);
+        free(temp);
+    }
+    free(catalogo);
+    catalogo = NULL;
+    capacidadeCatalogo = 0;
+    totalRegrasCatalogo = 0;
+}
+
+// ============================================================
+//  MODO DE COMANDOS
+// ============================================================
+//
+// Protocolo de linhas (uma instrução por linha):
+//   e | d          → move para a esquerda / direita
+//   ir <sala>      → vai direto para a sala com esse nome
+//   caminho <sala> → lista as salas entre a sala atual e a sala indicada
+//   pistas         → lista as pistas coletadas
+//   associacoes    → lista as associações pista → suspeito
+//   suspeito <pista> → mostra o suspeito associado a uma pista
+//   suspeitos      → lista cada suspeito com suas pistas
+//   pistas-de <nome> → lista as pistas associadas a um suspeito
+//   estatisticas   → mostra as estatísticas do filtro de Bloom
+//   acusar <nome>  → acusa um suspeito e encerra
+//   sair           → encerra sem acusar
+//
+// Os comandos podem chegar em lote (vários por leitura); cada bloco lido é
+// processado inteiro antes de a saída ser descarregada de uma só vez.
+
+/**
+ * @brief Lê comandos da entrada padrão em blocos e os executa em sequência.
+ * @param salaInicial Sala onde a sessão começa.
+ * @param arvorePistas Ponteiro para a árvore de pistas coletadas.
+ */
+void executarModoComandos(Sala* salaInicial, PistaNode** arvorePistas) {
+    char bloco[TAM_BLOCO_COMANDOS + 1];
+    size_t pendente = 0;
+    int descartando = 0;  // restante de uma linha longa demais: ignora até o próximo '\n'
+    Sala* salaAtual = salaInicial;
+
+    printf("SALA %s\n", salaAtual->nome);
+    coletarPistaDaSala(salaAtual, arvorePistas);
+    fflush(stdout);
+
+    while (1) {
+        // read() devolve o que já chegou, sem esperar o bloco encher como fread()
+        ssize_t lidos = read(STDIN_FILENO, bloco + pendente, TAM_BLOCO_COMANDOS - pendente);
+        if (lidos < 0 && errno == EINTR)
+            continue;
+
+        size_t total = pendente + (lidos > 0 ? (size_t) lidos : 0);
+        size_t inicio = 0;
+
+        // Fim da entrada (ou erro de leitura): a última linha pode vir sem '\n'
+        if (lidos <= 0) {
+            if (total > 0 && !descartando) {
+                bloco[total] = '\0';
+                executarComando(bloco, &salaAtual, arvorePistas);
+            }
+            break;
+        }
+
+        for (size_t i = 0; i < total; i++) {
+            if (bloco[i] != '\n')
+                continue;
+            bloco[i] = '\0';
+            if (descartando) {
+                descartando = 0;
+            } else if (!executarComando(bloco + inicio, &salaAtual, arvorePistas)) {
+                fflush(stdout);
                 return;
             }
-            atual = atual->prox;
+            inicio = i + 1;
+        }
+
+        // Linha maior que o bloco inteiro: descarta até o fim dela, inclusive
+        // o que ainda vier nas próximas leituras
+        if (!descartando && inicio == 0 && total == TAM_BLOCO_COMANDOS) {
+            printf("ERRO comando muito longo\n");
+            descartando = 1;
         }
+        if (descartando)
+            inicio = total;
+        fflush(stdout);
+
+        // Um commit do diário por bloco de comandos recebido
+        gravarLoteDiario();
+
+        pendente = total - inicio;
+        memmove(bloco, bloco + inicio, pendente);
     }
+    fflush(stdout);
+}
+
 
-    printf("Nenhuma pista contra esse suspeito.\n");
+/**
+ * @brief Executa um único comando do protocolo de linhas.
+ * @param linha Linha do comando (modificada no lugar).
+ * @param salaAtual Ponteiro para a sala atual da sessão.
+ * @param arvorePistas Ponteiro para a árvore de pistas coletadas.
+ * @return 0 se a sessão foi encerrada, 1 caso contrário.
+ */
+int executarComando(char* linha, Sala** salaAtual, PistaNode** arvorePistas) {
+    linha[strcspn(linha, "\r")] = '\0';
+
+    if (strlen(linha) == 0)
+        return 1;
+
+    if (strcmp(linha, "e") == 0 || strcmp(linha, "d") == 0) {
+        Sala* destino = (linha[0] == 'e') ? (*salaAtual)->esquerda : (*salaAtual)->direita;
+        if (destino == NULL) {
+            printf("ERRO sem caminho\n");
+            return 1;
+        }
+        *salaAtual = destino;
+        printf("SALA %s\n", destino->nome);
+        coletarPistaDaSala(destino, arvorePistas);
+    }
+    else if (strncmp(linha, "ir ", 3) == 0 || strncmp(linha, "caminho ", 8) == 0) {
+        int teletransporte = (linha[0] == 'i');
+        Sala* destino = buscarSala(linha + (teletransporte ? 3 : 8));
+        if (destino == NULL) {
+            printf("ERRO sala desconhecida\n");
+            return 1;
+        }
+        if (teletransporte) {
+            *salaAtual = destino;
+            printf("SALA %s\n", destino->nome);
+            coletarPistaDaSala(destino, arvorePistas);
+        } else {
+            exibirCaminho(*salaAtual, destino);
+            printf("FIM\n");
+        }
+    }
+    else if (strcmp(linha, "pistas") == 0) {
+        exibirPistas(*arvorePistas);
+        printf("FIM\n");
+    }
+    else if (strcmp(linha, "associacoes") == 0) {
+        listarAssociacoes();
+        printf("FIM\n");
+    }
+    else if (strncmp(linha, "suspeito ", 9) == 0) {
+        char* suspeito = encontrarSuspeito(linha + 9);
+        if (suspeito != NULL)
+            printf("SUSPEITO %s\n", suspeito);
+        else
+            printf("ERRO pista sem suspeito\n");
+    }
+    else if (strcmp(linha, "suspeitos") == 0) {
+        listarSuspeitos();
+        printf("FIM\n");
+    }
+    else if (strncmp(linha, "pistas-de ", 10) == 0) {
+        Suspeito* suspeito = buscarSuspeito(linha + 10);
+        if (suspeito != NULL)
+            listarPistasDoSuspeito(suspeito);
+        printf("FIM\n");
+    }
+    else if (strcmp(linha, "estatisticas") == 0) {
+        exibirEstatisticasBloom();
+        printf("FIM\n");
+    }
+    else if (strncmp(linha, "acusar ", 7) == 0) {
+        avaliarAcusacao(linha + 7);
+        return 0;
+    }
+    else if (strcmp(linha, "sair") == 0) {
+        return 0;
+    }
+    else {
+        printf("ERRO comando desconhecido: %s\n", linha);
+    }
+
+    return 1;
 }
 
 // ============================================================
@@ -438,5 +2248,14 @@ void freeTabelaHash() {
             free(temp);
         }
         tabelaHash[i] = NULL;
+
+        Suspeito* suspeito = tabelaSuspeitos[i];
+        while (suspeito) {
+            Suspeito* temp = suspeito;
+            suspeito = suspeito->prox;
+            free(temp->pistas);
+            free(temp);
+        }
+        tabelaSuspeitos[i] = NULL;
     }
 }
\ No newline at end of file